@@ -3,8 +3,18 @@
 
 #include "hittable.hpp"
 #include "material.hpp"
+#include <algorithm>
+#include <bit>
 #include <omp.h>
 #include <random>
+#include <utility>
+#include <vector>
+
+enum class Image_Format {
+  PPM_ASCII,  // Plain text P3 PPM
+  PPM_BINARY, // Raw byte P6 PPM
+  PFM         // Linear 32-bit float RGB, stored bottom row first
+};
 
 class Camera {
 private:
@@ -19,6 +29,8 @@ private:
   Vec3 defocus_disk_u; // Defocus disk horizizontal radius
   Vec3 defocus_disk_v; // Defocus disk vertical radius
 
+  static constexpr int segment_width = 16; // Pixels per unit of render work
+
   void initialize() {
     image_height = int(image_width / aspect_ratio);
     image_height = (image_height < 1) ? 1 : image_height;
@@ -59,26 +71,32 @@ private:
     defocus_disk_v = v * defocus_radius;
   }
 
-  Ray get_ray(int i, int j, std::mt19937 &rng) {
-    // Construct a camera ray originating from the origin and directed at
-    // randomly sampled points around the pixel location i, j
-
-    auto offset{sample_square(rng)};
-    auto pixel_sample{pixel_100_loc + ((i + offset.x()) * pixel_delta_u) +
-                      ((j + offset.y()) * pixel_delta_v)};
+  template <bool Thin_Lens>
+  Ray get_ray(const Vec3 &to_pixel_corner, std::mt19937 &rng) const {
+    // Construct a camera ray directed at a randomly sampled point in the pixel
+    // whose upper left corner is center + to_pixel_corner, from the camera
+    // center or the defocus disk. Directions are built relative to the camera
+    // center so the pinhole case needs no per-sample subtraction.
 
-    auto ray_origin = (defocus_angle <= 0) ? center : defocus_disk_sample(rng);
-    auto ray_direction = pixel_sample - ray_origin;
+    auto [du, dv] = sample_square(rng);
+    Vec3 direction{to_pixel_corner + (du * pixel_delta_u) +
+                   (dv * pixel_delta_v)};
 
-    return Ray(ray_origin, ray_direction);
+    if constexpr (Thin_Lens) {
+      Vec3 lens_offset{defocus_disk_sample(rng)};
+      return Ray(center + lens_offset, direction - lens_offset);
+    } else {
+      return Ray(center, direction);
+    }
   }
 
-  Vec3 sample_square(std::mt19937 &rng) const {
-    // Returns the vector to a random point in the [-.5, -.5] - [+.5, +.5] unit
-    // space
-    static thread_local std::uniform_real_distribution<double> distribution(
-        0.0, 1.0);
-    return Vec3(distribution(rng) - 0.5, distribution(rng) - 0.5, 0);
+  std::pair<double, double> sample_square(std::mt19937 &rng) const {
+    // Returns a random point in the [0, 0] - [1, 1] unit square. Sub-pixel
+    // jitter doesn't need double precision, and a float takes one 32-bit draw
+    // from the generator where a double takes two.
+    static thread_local std::uniform_real_distribution<float> distribution(
+        0.0f, 1.0f);
+    return {distribution(rng), distribution(rng)};
   }
 
   Color ray_color(const Ray &r, int depth, const Hittable &world,
@@ -102,10 +120,18 @@ private:
     return (1.0 - a) * Color(1.0, 1.0, 1.0) + a * Color(0.5, 0.7, 1.0);
   }
 
-  Point3 defocus_disk_sample(std::mt19937 &rng) const {
-    // Returns random point in rhe camera defocus disk
-    auto p{random_in_unit_disk(rng)};
-    return center + (p[0] * defocus_disk_u) + (p[1] * defocus_disk_v);
+  Vec3 defocus_disk_sample(std::mt19937 &rng) const {
+    // Returns a random offset from the camera center within the defocus disk.
+    // Rejection sampled like random_in_unit_disk, but at float precision to
+    // halve the generator draws per attempt.
+    static thread_local std::uniform_real_distribution<float> distribution(
+        -1.0f, 1.0f);
+    float x, y;
+    do {
+      x = distribution(rng);
+      y = distribution(rng);
+    } while (x * x + y * y >= 1.0f);
+    return (x * defocus_disk_u) + (y * defocus_disk_v);
   }
 
 public:
@@ -123,34 +149,117 @@ public:
   double focus_dist =
       10; // Distance from camera lookform point to plane of perfect focus
 
-  void render(const Hittable &world) {
+  Image_Format output_format = Image_Format::PPM_ASCII;
+  // Upper bound in bytes on finished pixels held in memory before they are
+  // flushed to the output stream. The image is rendered in bands of whole
+  // scanlines that fit this budget (at least one scanline per band).
+  std::size_t framebuffer_budget = std::size_t(64) << 20;
+
+  void render(const Hittable &world, std::ostream &out = std::cout) {
     initialize();
-    std::cout << "P3\n" << image_width << ' ' << image_height << "\n255\n";
-    std::vector<Color> image(image_width * image_height);
+    write_header(out);
+
+    int band_rows = static_cast<int>(std::clamp<std::size_t>(
+        framebuffer_budget / (sizeof(Color) * image_width), 1,
+        std::size_t(image_height)));
+    std::vector<Color> pixels(std::size_t(band_rows) * image_width);
+
+    // PFM expects scanlines bottom to top, so walk the bands in reverse to
+    // keep the output a single forward stream.
+    bool bottom_up = output_format == Image_Format::PFM;
+    int band_count = (image_height + band_rows - 1) / band_rows;
+
+    // Resolve the configuration once so the per-pixel loops don't branch on
+    // it: a kernel specialized for the lens model, and the pixel writer
+    auto band_kernel = (defocus_angle <= 0) ? &Camera::render_band<false>
+                                            : &Camera::render_band<true>;
+    auto write_pixel = pixel_writer();
+
+    for (int b = 0; b < band_count; b++) {
+      int band = bottom_up ? band_count - 1 - b : b;
+      int j0 = band * band_rows;
+      int j1 = std::min(j0 + band_rows, image_height);
+
+      std::clog << "\rScanlines remaining: " << (image_height - b * band_rows)
+                << " " << std::flush;
+      (this->*band_kernel)(world, j0, j1, pixels.data());
+
+      for (int row = 0; row < j1 - j0; row++) {
+        int local_j = bottom_up ? (j1 - j0 - 1 - row) : row;
+        const Color *pixel = &pixels[std::size_t(local_j) * image_width];
+        for (int i = 0; i < image_width; i++) {
+          write_pixel(out, pixel[i]);
+        }
+      }
+    }
+    out.flush();
+    std::clog << "\rDone.               \n";
+  }
+
+private:
+  template <bool Thin_Lens>
+  void render_band(const Hittable &world, int j0, int j1, Color *band) {
+    // Render scanlines [j0, j1) into band, row-major starting at row j0.
+    // Work is shared out in fixed segments of a scanline rather than whole
+    // rows, so a band of a single scanline still keeps every thread busy.
+    int segments = (image_width + segment_width - 1) / segment_width;
+    Vec3 to_first_corner{pixel_100_loc - center -
+                         0.5 * (pixel_delta_u + pixel_delta_v)};
+
 #pragma omp parallel for schedule(dynamic, 1) collapse(2)
-    for (int j = 0; j < image_height; j++) {
-      for (int i = 0; i < image_width; i++) {
+    for (int j = j0; j < j1; j++) {
+      for (int segment = 0; segment < segments; segment++) {
         thread_local std::mt19937 rng(std::random_device{}() +
                                       omp_get_thread_num());
-        Color pixel_color(0, 0, 0);
-        for (int sample = 0; sample < samples_per_pixel; sample++) {
-          Ray r{get_ray(i, j, rng)};
-          pixel_color += ray_color(r, max_depth, world, rng);
+        int i0 = segment * segment_width;
+        int i1 = std::min(i0 + segment_width, image_width);
+        Color *pixel = band + std::size_t(j - j0) * image_width;
+
+        // Locate the segment's first pixel once, then step along the row
+        Vec3 to_pixel_corner{to_first_corner + (i0 * pixel_delta_u) +
+                             (j * pixel_delta_v)};
+        for (int i = i0; i < i1; i++, to_pixel_corner += pixel_delta_u) {
+          Color pixel_color(0, 0, 0);
+          for (int sample = 0; sample < samples_per_pixel; sample++) {
+            Ray r{get_ray<Thin_Lens>(to_pixel_corner, rng)};
+            pixel_color += ray_color(r, max_depth, world, rng);
+          }
+          pixel[i] = pixel_samples_scale * pixel_color;
         }
-        image[j * image_width + i] = pixel_samples_scale * pixel_color;
       }
     }
+  }
+
+  void write_header(std::ostream &out) const {
+    switch (output_format) {
+    case Image_Format::PPM_ASCII:
+      out << "P3\n" << image_width << ' ' << image_height << "\n255\n";
+      break;
+    case Image_Format::PPM_BINARY:
+      out << "P6\n" << image_width << ' ' << image_height << "\n255\n";
+      break;
+    case Image_Format::PFM:
+      // A negative scale marks little-endian sample data
+      out << "PF\n"
+          << image_width << ' ' << image_height << '\n'
+          << (std::endian::native == std::endian::little ? "-1.0" : "1.0")
+          << '\n';
+      break;
+    }
+  }
 
-    for (int j = 0; j < image_height; j++) {
-      if (j % 10 == 0) {
-        std::clog << "\rScanlines remaining: " << (image_height - j) << " "
-                  << std::flush;
-      }
-      for (int i = 0; i < image_width; i++) {
-        write_color(std::cout, image[j * image_width + i]);
-      }
+  using Pixel_Writer = void (*)(std::ostream &, const Color &);
+
+  Pixel_Writer pixel_writer() const {
+    switch (output_format) {
+    case Image_Format::PPM_ASCII:
+      return write_color;
+    case Image_Format::PPM_BINARY:
+      return write_color_binary;
+    case Image_Format::PFM:
+      return write_color_pfm;
     }
-    std::clog << "\rDone.               \n";
+    return write_color; // Not reached, every format is handled above
   }
 };
 
@@ -13,24 +13,37 @@ inline double linear_to_gamma(double linear_componenet) {
   return 0;
 }
 
-void write_color(std::ostream &out, const Color &pixel_color) {
-  double r{pixel_color.x()};
-  double g{pixel_color.y()};
-  double b{pixel_color.z()};
-
-  // Apply a linear to gamma transform for gamma 2
-  r = linear_to_gamma(r);
-  g = linear_to_gamma(g);
-  b = linear_to_gamma(b);
-
-  // Translate the [0, 1] component values to the byte range [0, 255].
+inline int linear_to_byte(double linear_component) {
+  // Apply a linear to gamma transform for gamma 2, then translate the [0, 1]
+  // component value to the byte range [0, 255].
   static const Interval intensity(0.000, 0.999);
-  int rByte = static_cast<int>(256 * intensity.clamp(r));
-  int gByte = static_cast<int>(256 * intensity.clamp(g));
-  int bByte = static_cast<int>(256 * intensity.clamp(b));
+  return static_cast<int>(256 *
+                          intensity.clamp(linear_to_gamma(linear_component)));
+}
+
+void write_color(std::ostream &out, const Color &pixel_color) {
+  int rByte = linear_to_byte(pixel_color.x());
+  int gByte = linear_to_byte(pixel_color.y());
+  int bByte = linear_to_byte(pixel_color.z());
 
   // Write out the pixel color components.
   out << rByte << " " << gByte << " " << bByte << "\n";
 }
 
+inline void write_color_binary(std::ostream &out, const Color &pixel_color) {
+  // Raw bytes for a binary (P6) PPM
+  char bytes[3] = {static_cast<char>(linear_to_byte(pixel_color.x())),
+                   static_cast<char>(linear_to_byte(pixel_color.y())),
+                   static_cast<char>(linear_to_byte(pixel_color.z()))};
+  out.write(bytes, sizeof(bytes));
+}
+
+inline void write_color_pfm(std::ostream &out, const Color &pixel_color) {
+  // PFM stores linear radiance as native-endian 32-bit floats, no gamma
+  float rgb[3] = {static_cast<float>(pixel_color.x()),
+                  static_cast<float>(pixel_color.y()),
+                  static_cast<float>(pixel_color.z())};
+  out.write(reinterpret_cast<const char *>(rgb), sizeof(rgb));
+}
+
 #endif // !COLOR_HPP
@@ -7,7 +7,7 @@ class Hit_Record {
 public:
   Point3 p;
   Vec3 normal;
-  shared_ptr<Material> mat;
+  const Material *mat = nullptr; // Non-owning; the scene keeps it alive
   double t;
   bool front_face;
 
@@ -0,0 +1,156 @@
+#ifndef SCENE_ARENA_HPP
+#define SCENE_ARENA_HPP
+
+#include "hittable.hpp"
+#include "material.hpp"
+#include "sphere.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+// Passes allocations through to the default resource and keeps a running
+// total, so the scene can report what its material pool actually reserved.
+class Counting_Resource : public std::pmr::memory_resource {
+private:
+  std::size_t allocated = 0;
+
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+    void *p = std::pmr::get_default_resource()->allocate(bytes, alignment);
+    allocated += bytes;
+    return p;
+  }
+
+  void do_deallocate(void *p, std::size_t bytes,
+                     std::size_t alignment) override {
+    std::pmr::get_default_resource()->deallocate(p, bytes, alignment);
+    allocated -= bytes;
+  }
+
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+
+public:
+  std::size_t bytes_allocated() const { return allocated; }
+};
+
+// Flat scene storage. Spheres live in one contiguous array in traversal
+// (insertion) order using a compact float encoding, and reference their
+// material by a 32-bit index. Materials are placed back to back in a
+// monotonic arena owned by the scene, so there is one allocation per block
+// rather than one (plus a control block) per object.
+class Scene_Arena : public Hittable {
+public:
+  using Material_Id = std::uint32_t;
+
+  Scene_Arena() : material_pool(initial_material_bytes, &material_upstream) {}
+  Scene_Arena(const Scene_Arena &) = delete;
+  Scene_Arena &operator=(const Scene_Arena &) = delete;
+
+  ~Scene_Arena() {
+    // The monotonic pool releases its memory in bulk but never runs
+    // destructors, so do that here.
+    for (auto *mat : materials) {
+      mat->~Material();
+    }
+  }
+
+  template <typename T, typename... Args>
+  Material_Id add_material(Args &&...args) {
+    std::pmr::polymorphic_allocator<> alloc(&material_pool);
+    materials.push_back(alloc.new_object<T>(std::forward<Args>(args)...));
+    material_bytes += sizeof(T);
+    return static_cast<Material_Id>(materials.size() - 1);
+  }
+
+  void add_sphere(const Point3 &center, double radius, Material_Id mat) {
+    assert(mat < materials.size() && "add_sphere: unknown material id");
+    spheres.push_back({{static_cast<float>(center.x()),
+                        static_cast<float>(center.y()),
+                        static_cast<float>(center.z())},
+                       static_cast<float>(std::fmax(0, radius))});
+    sphere_materials.push_back(mat);
+  }
+
+  void reserve(std::size_t sphere_count) {
+    spheres.reserve(sphere_count);
+    sphere_materials.reserve(sphere_count);
+  }
+
+  bool hit(const Ray &r, Interval ray_t, Hit_Record &rec) const override {
+    // Find the closest sphere first, then fill in the hit record once
+    std::size_t closest = spheres.size();
+    auto closest_so_far{ray_t.max};
+
+    for (std::size_t k = 0; k < spheres.size(); k++) {
+      double root;
+      if (hit_sphere(center_of(spheres[k]), spheres[k].radius, r,
+                     Interval(ray_t.min, closest_so_far), root)) {
+        closest = k;
+        closest_so_far = root;
+      }
+    }
+
+    if (closest == spheres.size()) {
+      return false;
+    }
+
+    const auto &sphere = spheres[closest];
+    Point3 center{center_of(sphere)};
+    rec.t = closest_so_far;
+    rec.p = r.at(rec.t);
+    Vec3 outward_normal = (rec.p - center) / double(sphere.radius);
+    rec.set_face_normal(r, outward_normal);
+    rec.mat = materials[sphere_materials[closest]];
+
+    return true;
+  }
+
+  std::size_t primitive_count() const { return spheres.size(); }
+
+  static constexpr std::size_t bytes_per_primitive() {
+    return sizeof(Compact_Sphere) + sizeof(Material_Id);
+  }
+
+  std::size_t footprint_bytes() const {
+    // Everything the scene holds on the heap, counting the material pool's
+    // blocks rather than the objects in them, plus the arena object itself
+    return spheres.capacity() * sizeof(Compact_Sphere) +
+           sphere_materials.capacity() * sizeof(Material_Id) +
+           materials.capacity() * sizeof(Material *) +
+           material_upstream.bytes_allocated() + sizeof(*this);
+  }
+
+  void print_stats(std::ostream &out) const {
+    out << "Scene: " << primitive_count() << " primitives, "
+        << materials.size() << " materials, " << bytes_per_primitive()
+        << " bytes/primitive, " << footprint_bytes() << " bytes total ("
+        << material_upstream.bytes_allocated() << " reserved for materials, "
+        << material_bytes << " of them in use)\n";
+  }
+
+private:
+  struct Compact_Sphere {
+    float center[3];
+    float radius;
+  };
+  static_assert(sizeof(Compact_Sphere) == 16,
+                "Compact_Sphere must stay 16 bytes");
+
+  static constexpr std::size_t initial_material_bytes = 4096;
+
+  std::vector<Compact_Sphere> spheres;
+  std::vector<Material_Id> sphere_materials; // Parallel to spheres
+  std::vector<Material *> materials;         // Indexed by Material_Id
+  std::size_t material_bytes = 0; // Sum of material object sizes
+  Counting_Resource material_upstream; // Must outlive material_pool
+  std::pmr::monotonic_buffer_resource material_pool;
+
+  static Point3 center_of(const Compact_Sphere &sphere) {
+    return Point3(sphere.center[0], sphere.center[1], sphere.center[2]);
+  }
+};
+
+#endif // !SCENE_ARENA_HPP
@@ -0,0 +1,126 @@
+#ifndef SCENES_HPP
+#define SCENES_HPP
+
+#include "camera.hpp"
+#include "material.hpp"
+#include "scene_arena.hpp"
+
+#include <string>
+
+// Canonical scenes shared by the renderer and the regression suite. Each one
+// fills the world and points the camera; image width and samples per pixel
+// are left to the caller.
+//
+// NOTE: final_scene draws from the global random_double()/Vec3::random()
+// generators, so it only reproduces the same layout when it is the first
+// scene built in the process.
+
+inline void final_scene(Scene_Arena &world, Camera &camera) {
+  world.reserve(22 * 22 + 4);
+
+  auto ground_material{world.add_material<Lambertian>(Color(0.5, 0.5, 0.5))};
+  world.add_sphere(Point3(0, -1000, 0), 1000, ground_material);
+
+  // Every glass sphere shares the same material
+  auto glass{world.add_material<Dielectric>(1.5)};
+
+  for (int a{-11}; a < 11; a++) {
+    for (int b{-11}; b < 11; b++) {
+      auto choose_mat{random_double()};
+      Point3 center(a + 0.9 * random_double(), 0.2, b + 0.9 * random_double());
+
+      if ((center - Point3(4, 0.2, 0)).length() > 0.9) {
+        Scene_Arena::Material_Id sphere_material;
+
+        if (choose_mat < 0.8) {
+          // Diffuse
+          auto albedo{Color::random() * Color::random()};
+          sphere_material = world.add_material<Lambertian>(albedo);
+          world.add_sphere(center, 0.2, sphere_material);
+        } else if (choose_mat < 0.95) {
+          // Metal
+          auto albedo{Color::random(0.5, 1)};
+          auto fuzz{random_double(0, 0.5)};
+          sphere_material = world.add_material<Metal>(albedo, fuzz);
+          world.add_sphere(center, 0.2, sphere_material);
+        } else {
+          // Glass
+          sphere_material = glass;
+          world.add_sphere(center, 0.2, sphere_material);
+        }
+      }
+    }
+  }
+
+  world.add_sphere(Point3(0, 1, 0), 1.0, glass);
+
+  auto material2{world.add_material<Lambertian>(Color(0.4, 0.2, 0.1))};
+  world.add_sphere(Point3(-4, 1, 0), 1.0, material2);
+
+  auto material3{world.add_material<Metal>(Color(0.7, 0.6, 0.5), 0.0)};
+  world.add_sphere(Point3(4, 1, 0), 1.0, material3);
+
+  camera.aspect_ratio = 16.0 / 9.0;
+  camera.max_depth = 50;
+
+  camera.vfov = 20;
+  camera.lookfrom = Point3(13, 2, 3);
+  camera.lookat = Point3(0, 0, 0);
+  camera.vup = Vec3(0, 1, 0);
+
+  camera.defocus_angle = 0.6;
+  camera.focus_dist = 10.0;
+}
+
+inline void materials_scene(Scene_Arena &world, Camera &camera) {
+  // Diffuse, hollow glass and fuzzy metal spheres seen through a pinhole
+  auto material_ground{world.add_material<Lambertian>(Color(0.8, 0.8, 0.0))};
+  auto material_center{world.add_material<Lambertian>(Color(0.1, 0.2, 0.5))};
+  auto material_left{world.add_material<Dielectric>(1.50)};
+  auto material_bubble{world.add_material<Dielectric>(1.00 / 1.50)};
+  auto material_right{world.add_material<Metal>(Color(0.8, 0.6, 0.2), 1.0)};
+
+  world.add_sphere(Point3(0.0, -100.5, -1.0), 100.0, material_ground);
+  world.add_sphere(Point3(0.0, 0.0, -1.2), 0.5, material_center);
+  world.add_sphere(Point3(-1.0, 0.0, -1.0), 0.5, material_left);
+  world.add_sphere(Point3(-1.0, 0.0, -1.0), 0.4, material_bubble);
+  world.add_sphere(Point3(1.0, 0.0, -1.0), 0.5, material_right);
+
+  camera.aspect_ratio = 16.0 / 9.0;
+  camera.max_depth = 50;
+
+  camera.vfov = 90;
+  camera.lookfrom = Point3(0, 0, 0);
+  camera.lookat = Point3(0, 0, -1);
+  camera.vup = Vec3(0, 1, 0);
+
+  camera.defocus_angle = 0;
+}
+
+inline void dof_scene(Scene_Arena &world, Camera &camera) {
+  // The materials scene through a wide-aperture thin lens
+  materials_scene(world, camera);
+
+  camera.vfov = 20;
+  camera.lookfrom = Point3(-2, 2, 1);
+  camera.lookat = Point3(0, 0, -1);
+
+  camera.defocus_angle = 10.0;
+  camera.focus_dist = 3.4;
+}
+
+inline bool load_scene(const std::string &name, Scene_Arena &world,
+                       Camera &camera) {
+  // Builds the scene with the given name, returns false if there is none
+  if (name == "final")
+    final_scene(world, camera);
+  else if (name == "materials")
+    materials_scene(world, camera);
+  else if (name == "dof")
+    dof_scene(world, camera);
+  else
+    return false;
+  return true;
+}
+
+#endif // !SCENES_HPP
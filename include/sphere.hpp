@@ -3,6 +3,32 @@
 
 #include "hittable.hpp"
 
+inline bool hit_sphere(const Point3 &center, double radius, const Ray &r,
+                       Interval ray_t, double &root) {
+  // Finds the nearest ray parameter within ray_t where r meets the sphere
+  Vec3 oc{center - r.origin()};
+  auto a{r.direction().length_squared()};
+  auto h{dot(r.direction(), oc)};
+  auto c{oc.length_squared() - radius * radius};
+
+  auto discriminant{h * h - a * c};
+  if (discriminant < 0) {
+    return false;
+  }
+
+  auto sqrtd{std::sqrt(discriminant)};
+
+  // Find the nearest root that lies in the acceptable range
+  root = (h - sqrtd) / a;
+  if (!ray_t.surrounds(root)) {
+    root = (h + sqrtd) / a;
+    if (!ray_t.surrounds(root)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 class Sphere : public Hittable {
 private:
   Point3 center;
@@ -16,32 +42,16 @@ public:
   }
 
   bool hit(const Ray &r, Interval ray_t, Hit_Record &rec) const override {
-    Vec3 oc{center - r.origin()};
-    auto a{r.direction().length_squared()};
-    auto h{dot(r.direction(), oc)};
-    auto c{oc.length_squared() - radius * radius};
-
-    auto discriminant{h * h - a * c};
-    if (discriminant < 0) {
+    double root;
+    if (!hit_sphere(center, radius, r, ray_t, root)) {
       return false;
     }
 
-    auto sqrtd{std::sqrt(discriminant)};
-
-    // Find the nearest root that lies in the acceptable range
-    auto root{(h - sqrtd) / a};
-    if (!ray_t.surrounds(root)) {
-      root = (h + sqrtd) / a;
-      if (!ray_t.surrounds(root)) {
-        return false;
-      }
-    }
-
     rec.t = root;
     rec.p = r.at(rec.t);
     Vec3 outward_normal = (rec.p - center) / radius;
     rec.set_face_normal(r, outward_normal);
-    rec.mat = mat;
+    rec.mat = mat.get();
 
     return true;
   }
@@ -0,0 +1,55 @@
+// Checks that a render limited to one scanline per band still spreads that
+// scanline across several OpenMP threads.
+//
+// The image is a single row rendered with a framebuffer budget too small for
+// even that row, so the whole render is one band of one scanline. The world
+// records which threads intersect rays against it.
+
+#include "../include/raytracing.hpp"
+
+#include "../include/camera.hpp"
+#include "../include/hittable.hpp"
+
+#include <atomic>
+#include <bit>
+#include <sstream>
+
+namespace {
+
+const int thread_count = 4;
+
+class Thread_Recorder : public Hittable {
+public:
+  mutable std::atomic<unsigned> threads_seen{0};
+
+  bool hit(const Ray &, Interval, Hit_Record &) const override {
+    threads_seen |= 1u << omp_get_thread_num();
+    return false;
+  }
+};
+
+} // namespace
+
+int main() {
+  omp_set_num_threads(thread_count);
+
+  Thread_Recorder world;
+  Camera camera;
+  camera.image_width = 1024;
+  camera.aspect_ratio = 1024.0; // One scanline
+  camera.samples_per_pixel = 1000;
+  camera.framebuffer_budget = 1;
+  camera.output_format = Image_Format::PPM_BINARY;
+
+  std::ostringstream out;
+  camera.render(world, out);
+
+  int seen = std::popcount(world.threads_seen.load());
+  std::cout << seen << " of " << thread_count
+            << " threads rendered the scanline\n";
+  if (seen < 2) {
+    std::cerr << "FAIL: a one-scanline band ran on a single thread\n";
+    return 1;
+  }
+  return 0;
+}
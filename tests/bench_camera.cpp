@@ -0,0 +1,65 @@
+// Camera ray generation benchmark.
+//
+// Renders an empty world, so every sample is a generated ray that misses
+// straight into the sky, and reports samples per second for a pinhole and a
+// thin lens camera separately. Best of several runs to damp noise.
+//
+// Usage:
+//   bench_camera [runs]
+
+#include "../include/raytracing.hpp"
+
+#include "../include/camera.hpp"
+#include "../include/scene_arena.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+namespace {
+
+double samples_per_second(const Hittable &world, Camera camera, int runs) {
+  camera.aspect_ratio = 16.0 / 9.0;
+  camera.image_width = 640;
+  camera.samples_per_pixel = 64;
+  camera.output_format = Image_Format::PPM_BINARY;
+
+  // Discard the image, only the render loop is being timed
+  std::ostream null_out(nullptr);
+
+  double best = INF;
+  for (int run = 0; run < runs; run++) {
+    auto start = std::chrono::steady_clock::now();
+    camera.render(world, null_out);
+    best = std::min(best, std::chrono::duration<double>(
+                              std::chrono::steady_clock::now() - start)
+                              .count());
+  }
+
+  int image_height = int(camera.image_width / camera.aspect_ratio);
+  return double(camera.image_width) * image_height *
+         camera.samples_per_pixel / best;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  int runs = argc > 1 ? std::stoi(argv[1]) : 5;
+
+  Scene_Arena world;
+
+  Camera pinhole;
+  pinhole.lookfrom = Point3(13, 2, 3);
+  pinhole.lookat = Point3(0, 0, 0);
+  pinhole.vfov = 20;
+
+  Camera thin_lens = pinhole;
+  thin_lens.defocus_angle = 0.6;
+  thin_lens.focus_dist = 10.0;
+
+  std::cout << "pinhole:   " << samples_per_second(world, pinhole, runs) / 1e6
+            << " M samples/s\n";
+  std::cout << "thin lens: " << samples_per_second(world, thin_lens, runs) / 1e6
+            << " M samples/s\n";
+  return 0;
+}
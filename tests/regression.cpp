@@ -0,0 +1,249 @@
+// Performance and convergence regression check for one canonical scene.
+//
+// Renders the scene at a small fixed resolution and compares it against a
+// high sample count reference image, reporting
+//   - RMSE and relative MSE at a fixed number of samples per pixel,
+//   - relative MSE after a fixed wall clock budget,
+//   - throughput in camera samples per CPU-second,
+//   - efficiency, 1 / (relative MSE * CPU-seconds) at fixed spp.
+// Efficiency is the "quality per CPU-second" figure that is guarded: the run
+// fails when it drops below the stored baseline divided by the tolerance.
+// Timed renders run on a single OpenMP thread. std::clock() sums CPU time
+// over all threads, idle spinning included, so baselines would otherwise
+// depend on the core count of the machine that recorded them.
+//
+// Usage:
+//   regression <scene> <reference_dir> [--tolerance X]
+//   regression <scene> <reference_dir> --generate         (reference image)
+//   regression <scene> <reference_dir> --update-baseline  (efficiency)
+
+#include "../include/raytracing.hpp"
+
+#include "../include/camera.hpp"
+#include "../include/scene_arena.hpp"
+#include "../include/scenes.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+const int image_width = 80;
+const int reference_spp = 4096;
+const int test_spp = 16;
+const double min_cpu_time = 1.0; // Fixed spp renders repeat until this long
+const int pass_spp = 4;         // Samples per pass for the fixed time run
+const double time_budget = 2.0; // Wall clock seconds for the fixed time run
+const double default_tolerance = 1.5;
+
+struct Image {
+  int width = 0;
+  int height = 0;
+  std::vector<float> rgb;
+};
+
+bool read_pfm(std::istream &in, Image &image) {
+  // Reads a little-endian PFM as written by Camera::render. Rows stay in file
+  // order (bottom to top), which is all a per-pixel comparison needs.
+  std::string magic;
+  double scale;
+  if (!(in >> magic >> image.width >> image.height >> scale) ||
+      magic != "PF" || scale >= 0)
+    return false;
+  in.get(); // Single whitespace byte before the samples
+
+  image.rgb.resize(std::size_t(image.width) * image.height * 3);
+  in.read(reinterpret_cast<char *>(image.rgb.data()),
+          image.rgb.size() * sizeof(float));
+  return bool(in);
+}
+
+Image render(const Scene_Arena &world, Camera camera, int spp) {
+  camera.image_width = image_width;
+  camera.samples_per_pixel = spp;
+  camera.output_format = Image_Format::PFM;
+
+  std::stringstream buffer;
+  camera.render(world, buffer);
+
+  Image image;
+  if (!read_pfm(buffer, image)) {
+    std::cerr << "Could not parse the rendered PFM image\n";
+    std::exit(1);
+  }
+  return image;
+}
+
+double cpu_seconds() { return double(std::clock()) / CLOCKS_PER_SEC; }
+
+double rmse(const Image &image, const Image &reference) {
+  double sum = 0;
+  for (std::size_t k = 0; k < image.rgb.size(); k++) {
+    double d = image.rgb[k] - reference.rgb[k];
+    sum += d * d;
+  }
+  return std::sqrt(sum / image.rgb.size());
+}
+
+double relative_mse(const Image &image, const Image &reference) {
+  // Squared error relative to the reference value, with a small epsilon so
+  // black pixels don't dominate
+  double sum = 0;
+  for (std::size_t k = 0; k < image.rgb.size(); k++) {
+    double d = image.rgb[k] - reference.rgb[k];
+    sum += d * d / (double(reference.rgb[k]) * reference.rgb[k] + 1e-2);
+  }
+  return sum / image.rgb.size();
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  auto usage = [&]() {
+    std::cerr << "Usage: " << argv[0]
+              << " <scene> <reference_dir> [--tolerance X] [--generate]"
+                 " [--update-baseline]\n";
+    return 2;
+  };
+  if (argc < 3)
+    return usage();
+
+  std::string scene = argv[1];
+  std::string reference_dir = argv[2];
+  std::string reference_path = reference_dir + "/" + scene + ".pfm";
+  std::string baseline_path = reference_dir + "/" + scene + ".baseline";
+  double tolerance = default_tolerance;
+  bool generate = false;
+  bool update_baseline = false;
+
+  for (int k = 3; k < argc; k++) {
+    std::string arg = argv[k];
+    if (arg == "--tolerance") {
+      if (k + 1 >= argc)
+        return usage();
+      try {
+        tolerance = std::stod(argv[++k]);
+      } catch (const std::exception &) {
+        return usage();
+      }
+      if (!(tolerance > 0))
+        return usage();
+    } else if (arg == "--generate")
+      generate = true;
+    else if (arg == "--update-baseline")
+      update_baseline = true;
+    else
+      return usage();
+  }
+
+  Scene_Arena world;
+  Camera camera;
+  if (!load_scene(scene, world, camera)) {
+    std::cerr << "Unknown scene '" << scene << "'\n";
+    return 2;
+  }
+
+  if (generate) {
+    camera.image_width = image_width;
+    camera.samples_per_pixel = reference_spp;
+    camera.output_format = Image_Format::PFM;
+    std::ofstream out(reference_path, std::ios::binary);
+    camera.render(world, out);
+    std::cout << "Wrote " << reference_path << '\n';
+    return 0;
+  }
+
+  // Timed renders are single-threaded, see the note at the top
+  omp_set_num_threads(1);
+
+  Image reference;
+  std::ifstream reference_file(reference_path, std::ios::binary);
+  if (!read_pfm(reference_file, reference)) {
+    std::cerr << "Missing or unreadable reference " << reference_path << '\n';
+    return 1;
+  }
+
+  // Fixed samples per pixel, repeated so cheap scenes still give a stable
+  // timing; error and time are averaged over the repetitions
+  Image fixed_spp;
+  double fixed_spp_rmse = 0;
+  double fixed_spp_relmse = 0;
+  double cpu_time = 0;
+  int repetitions = 0;
+  while (repetitions == 0 || cpu_time < min_cpu_time) {
+    double cpu_start = cpu_seconds();
+    fixed_spp = render(world, camera, test_spp);
+    cpu_time += cpu_seconds() - cpu_start;
+    repetitions++;
+
+    if (fixed_spp.rgb.size() != reference.rgb.size()) {
+      std::cerr << "Reference " << reference_path << " is " << reference.width
+                << 'x' << reference.height << ", expected " << fixed_spp.width
+                << 'x' << fixed_spp.height << '\n';
+      return 1;
+    }
+    fixed_spp_rmse += rmse(fixed_spp, reference);
+    fixed_spp_relmse += relative_mse(fixed_spp, reference);
+  }
+  fixed_spp_rmse /= repetitions;
+  fixed_spp_relmse /= repetitions;
+  cpu_time /= repetitions;
+
+  double samples = double(fixed_spp.width) * fixed_spp.height * test_spp;
+  double throughput = samples / cpu_time;
+  double efficiency = 1.0 / (fixed_spp_relmse * cpu_time);
+
+  // Fixed wall clock time, averaging equal sized passes until the budget is
+  // spent
+  auto wall_start = std::chrono::steady_clock::now();
+  Image accumulated = render(world, camera, pass_spp);
+  int passes = 1;
+  while (std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       wall_start)
+             .count() < time_budget) {
+    Image pass = render(world, camera, pass_spp);
+    for (std::size_t k = 0; k < accumulated.rgb.size(); k++)
+      accumulated.rgb[k] += pass.rgb[k];
+    passes++;
+  }
+  for (auto &value : accumulated.rgb)
+    value /= passes;
+  double fixed_time_relmse = relative_mse(accumulated, reference);
+
+  std::cout << "scene " << scene << '\n'
+            << "  fixed spp (" << test_spp << "): RMSE " << fixed_spp_rmse
+            << ", relMSE " << fixed_spp_relmse << '\n'
+            << "  fixed time (" << time_budget << "s): relMSE "
+            << fixed_time_relmse << " at " << passes * pass_spp << " spp\n"
+            << "  throughput: " << throughput << " samples/CPU-s\n"
+            << "  efficiency: " << efficiency
+            << " (1 / relMSE / CPU-s at fixed spp)\n";
+
+  if (update_baseline) {
+    std::ofstream(baseline_path) << efficiency << '\n';
+    std::cout << "Wrote " << baseline_path << '\n';
+    return 0;
+  }
+
+  double baseline = 0;
+  std::ifstream baseline_file(baseline_path);
+  if (!(baseline_file >> baseline)) {
+    std::cout << "  no baseline at " << baseline_path << ", not checked\n";
+    return 0;
+  }
+
+  std::cout << "  baseline efficiency: " << baseline << ", tolerance "
+            << tolerance << '\n';
+  if (efficiency < baseline / tolerance) {
+    std::cerr << "FAIL: efficiency dropped to " << efficiency / baseline
+              << "x of baseline\n";
+    return 1;
+  }
+  return 0;
+}